@@ -0,0 +1,35 @@
+#ifndef BUSCA_H
+#define BUSCA_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Busca {
+// Par conhecido e espaço de chaves restrito para a busca DES
+struct Configuracao {
+    uint64_t textoClaro = 0;
+    uint64_t textoCifrado = 0;
+    uint64_t chaveBase = 0;        // valores dos bits fixos
+    int bitsLivres = 20;           // bits efetivos (não paridade) a enumerar, a partir do bit 0
+    unsigned threads = 1;
+    uint64_t tamanhoFaixa = 4096;  // candidatas por unidade de trabalho
+    bool incremental = true;       // false = gerarSubchavesDES a cada candidata
+};
+
+struct Resultado {
+    uint64_t chavesTestadas = 0;
+    unsigned long long roubos = 0; // faixas tomadas de outras threads
+    double segundos = 0;
+    std::vector<uint64_t> chavesEncontradas;
+};
+
+// Máscara dos bits de paridade, ignorados pelo PC1
+constexpr uint64_t MASCARA_PARIDADE = 0x8080808080808080ULL;
+
+// Percorre o espaço em código Gray: candidatas vizinhas diferem em um único bit,
+// e as subchaves são atualizadas por XOR (o escalonamento do DES é linear na chave)
+Resultado buscarChaveDES(const Configuracao& configuracao);
+}
+
+#endif // BUSCA_H
@@ -0,0 +1,33 @@
+#ifndef CARGA_H
+#define CARGA_H
+
+#include "protocolo.h"
+#include <string>
+#include <cstddef>
+
+namespace Carga {
+// Parâmetros do gerador de carga
+struct Configuracao {
+    std::string caminhoSocket = "/tmp/cryptmark.sock";
+    Protocolo::Algoritmo algoritmo = Protocolo::Algoritmo::DES;
+    Protocolo::Operacao operacao = Protocolo::Operacao::Criptografar;
+    unsigned conexoes = 4;
+    unsigned profundidade = 8;              // requisições em voo por conexão
+    size_t requisicoesPorConexao = 5000;
+    std::string mensagem = "Teste de diferentes algoritmos de criptografia";
+};
+
+// Vazão e latências (em μs) observadas pelo cliente
+struct Resultado {
+    size_t requisicoes = 0;
+    size_t erros = 0;
+    double segundos = 0;
+    double vazao = 0;
+    double p50 = 0, p99 = 0, p999 = 0;
+};
+
+// Dispara a carga contra um serviço já em execução e mede as respostas
+Resultado executarCarga(const Configuracao& configuracao);
+}
+
+#endif // CARGA_H
@@ -57,6 +57,10 @@ std::vector<uint64_t> criptografarDES(const std::string& mensagem, uint64_t chav
 
 // Descriptografa uma mensagem com DES
 std::string descriptografarDES(const std::vector<uint64_t>& textoCifrado, uint64_t chave);
+
+// Variantes que reutilizam subchaves já geradas (evita refazer o escalonamento)
+std::vector<uint64_t> criptografarDES(const std::string& mensagem, const std::array<uint64_t, 16>& subchaves);
+std::string descriptografarDES(const std::vector<uint64_t>& textoCifrado, const std::array<uint64_t, 16>& subchaves);
 }
 
 #endif // DES_H
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include <tuple>
 #include <vector>
 #include <string>
+#include <random>
+#include <cstdint>
+#include <cstddef>
 
 namespace GM {
 // Verifica se um número é primo
@@ -24,8 +27,41 @@ bool saoCoprimos(int a, int b);
 // Criptografa uma mensagem com Goldwasser-Micali
 std::vector<int> criptografarGM(const std::string& mensagem, const std::tuple<int, int>& chavePublica);
 
+// Variante que reutiliza um gerador já semeado (evita abrir random_device a cada chamada)
+std::vector<int> criptografarGM(const std::string& mensagem, const std::tuple<int, int>& chavePublica, std::mt19937& gen);
+
 // Descriptografa uma mensagem com Goldwasser-Micali
 std::string descriptografarGM(const std::vector<int>& textoCifrado, const std::tuple<int, int>& chavePrivada);
+
+// Redução de Barrett com constante pré-computada para um módulo ímpar n < 2^32
+struct ReducaoBarrett {
+    uint64_t n;
+    uint64_t mu; // floor(2^64 / n)
+
+    explicit ReducaoBarrett(uint64_t modulo) : n(modulo), mu(~0ULL / modulo) {}
+
+    uint64_t reduzir(uint64_t x) const {
+        uint64_t q = static_cast<uint64_t>((static_cast<unsigned __int128>(x) * mu) >> 64);
+        uint64_t r = x - q * n;
+        return r >= n ? r - n : r;
+    }
+
+    uint64_t multiplicar(uint64_t a, uint64_t b) const { return reduzir(a * b); }
+};
+
+// Número de threads de fato usado para `tamanho` cifras (`threads` = 0: todos os núcleos)
+unsigned threadsEfetivas(size_t tamanho, unsigned threads);
+
+// Operações homomórficas sobre cifras GM (in-place). `threads` = 0 usa todos os núcleos.
+// XOR bit a bit de duas cifras: c_i <- c_i * d_i mod n
+void xorCifras(std::vector<int>& cifras, const std::vector<int>& outras, const std::tuple<int, int>& chavePublica, unsigned threads = 1);
+
+// XOR com máscara em claro: c_i <- c_i * y mod n onde mascara_i = 1.
+// A máscara tem um byte (0 ou 1) por cifra, contíguo como o vetor de cifras.
+void xorMascara(std::vector<int>& cifras, const std::vector<uint8_t>& mascara, const std::tuple<int, int>& chavePublica, unsigned threads = 1);
+
+// Rerrandomiza sem alterar os bits: c_i <- c_i * r_i^2 mod n
+void rerandomizar(std::vector<int>& cifras, const std::tuple<int, int>& chavePublica, std::mt19937& gen, unsigned threads = 1);
 }
 
 #endif // GM_H
\ No newline at end of file
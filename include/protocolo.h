@@ -0,0 +1,68 @@
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+namespace Protocolo {
+// Algoritmos atendidos pelo serviço
+enum class Algoritmo : uint8_t { DES = 0, RSA = 1, GM = 2 };
+
+// Operações suportadas para cada algoritmo
+enum class Operacao : uint8_t { Criptografar = 0, Descriptografar = 1 };
+
+// Resultado de uma requisição
+enum class Status : uint8_t { Ok = 0, Erro = 1 };
+
+// Tamanho máximo do corpo de um quadro, em ambos os sentidos. Requisições cuja
+// resposta excederia o limite (RSA/GM expandem 4x/32x) recebem Status::Erro.
+constexpr size_t TAMANHO_MAXIMO_QUADRO = 1 << 20;
+
+// Requisição: [u32 tamanho][u32 id][u8 algoritmo][u8 operacao][dados]
+// Para DES, os 8 primeiros bytes de `dados` são a chave.
+struct Requisicao {
+    uint32_t id = 0;
+    Algoritmo algoritmo = Algoritmo::DES;
+    Operacao operacao = Operacao::Criptografar;
+    std::string dados;
+};
+
+// Resposta: [u32 tamanho][u32 id][u8 status][dados]
+struct Resposta {
+    uint32_t id = 0;
+    Status status = Status::Ok;
+    std::string dados;
+};
+
+// Serializa um quadro ao final do buffer de saída
+void serializarRequisicao(const Requisicao& requisicao, std::string& saida);
+void serializarResposta(const Resposta& resposta, std::string& saida);
+
+// Extrai o próximo quadro completo a partir de `posicao`, avançando-a.
+// Retorna false se o quadro ainda não chegou inteiro; lança se exceder o limite.
+bool extrairQuadro(const std::string& buffer, size_t& posicao, std::string_view& quadro);
+
+// Interpreta o corpo de um quadro; retorna false se o cabeçalho estiver incompleto.
+// Valores de algoritmo/operação não são validados aqui.
+bool desserializarRequisicao(std::string_view quadro, Requisicao& requisicao);
+bool desserializarResposta(std::string_view quadro, Resposta& resposta);
+
+// Conversões entre cifras e sua representação em bytes (little-endian)
+std::string blocosParaBytes(const std::vector<uint64_t>& blocos);
+std::vector<uint64_t> bytesParaBlocos(std::string_view bytes);
+std::string inteirosParaBytes(const std::vector<int>& valores);
+std::vector<int> bytesParaInteiros(std::string_view bytes);
+
+// Codifica/decodifica a chave DES no início dos dados da requisição
+std::string prefixarChaveDES(uint64_t chave, std::string_view dados);
+uint64_t lerChaveDES(std::string_view dados);
+
+// Conversão entre nomes ("des", "rsa", "gm") e algoritmos
+bool algoritmoPorNome(std::string_view nome, Algoritmo& algoritmo);
+const char* nomeAlgoritmo(Algoritmo algoritmo);
+}
+
+#endif // PROTOCOLO_H
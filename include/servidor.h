@@ -0,0 +1,116 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include "protocolo.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace Servidor {
+// Parâmetros do serviço de criptografia via socket Unix
+struct Configuracao {
+    std::string caminhoSocket = "/tmp/cryptmark.sock";
+    size_t tamanhoMaximoLote = 32;      // requisições por lote
+    long long esperaMaximaMicros = 200; // espera máxima para completar um lote
+    unsigned trabalhadores = 0;         // 0 = número de núcleos
+};
+
+// Contadores acumulados durante a execução
+struct Estatisticas {
+    unsigned long long requisicoes = 0;
+    unsigned long long lotes = 0;
+};
+
+// Serviço local que atende requisições DES/RSA/GM agrupadas em lotes.
+// Um laço epoll cuida das conexões; um pool de trabalhadores processa os lotes.
+class ServicoCriptografia {
+public:
+    // Gera as chaves RSA/GM e começa a escutar no socket
+    explicit ServicoCriptografia(const Configuracao& configuracao);
+    ~ServicoCriptografia();
+
+    ServicoCriptografia(const ServicoCriptografia&) = delete;
+    ServicoCriptografia& operator=(const ServicoCriptografia&) = delete;
+
+    // Executa o laço de eventos até que parar() seja chamado
+    void executar();
+
+    // Solicita o encerramento; seguro para uso em tratadores de sinal
+    void parar();
+
+    Estatisticas estatisticas() const;
+
+private:
+    using Relogio = std::chrono::steady_clock;
+
+    struct Conexao {
+        int fd = -1;
+        std::string entrada;
+        std::string saida;
+        bool aguardandoEscrita = false;
+        bool leituraEncerrada = false; // EOF ou quadro inválido: só resta responder
+        size_t emAndamento = 0;        // requisições enfileiradas ainda sem resposta
+    };
+
+    struct Pendente {
+        uint64_t conexao;
+        Protocolo::Requisicao requisicao;
+        Relogio::time_point chegada;
+    };
+
+    struct Concluida {
+        uint64_t conexao;
+        std::string quadro;
+    };
+
+    void aceitarConexoes();
+    void lerConexao(uint64_t id);
+    void escreverConexao(uint64_t id);
+    void fecharConexao(uint64_t id);
+    void atualizarInteresse(uint64_t id, Conexao& conexao);
+    void entregarRespostas();
+
+    void cicloTrabalhador();
+    void encerrarTrabalhadores();
+    std::vector<Pendente> coletarLote();
+    Protocolo::Resposta processar(const Protocolo::Requisicao& requisicao,
+                                  std::unordered_map<uint64_t, std::array<uint64_t, 16>>& subchavesDES,
+                                  std::mt19937& gen) const;
+
+    Configuracao configuracao;
+    std::tuple<int, int> chavePublicaRSA, chavePrivadaRSA;
+    std::tuple<int, int> chavePublicaGM, chavePrivadaGM;
+
+    int fdEscuta = -1;
+    int fdEpoll = -1;
+    int fdDespertar = -1;
+    std::atomic<bool> pararSolicitado{false};
+
+    std::unordered_map<uint64_t, Conexao> conexoes;
+    uint64_t proximaConexao = 0;
+
+    std::mutex mutexFila;
+    std::condition_variable cvFila;
+    std::deque<Pendente> fila;
+    bool encerrandoTrabalhadores = false;
+
+    std::mutex mutexConcluidas;
+    std::vector<Concluida> concluidas;
+
+    std::vector<std::thread> trabalhadores;
+    std::atomic<unsigned long long> totalRequisicoes{0};
+    std::atomic<unsigned long long> totalLotes{0};
+};
+}
+
+#endif // SERVIDOR_H
@@ -0,0 +1,147 @@
+#include "busca.h"
+#include "des.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace Busca {
+namespace {
+using Faixa = std::pair<uint64_t, uint64_t>; // [inicio, fim) em índices Gray
+using Subchaves = std::array<uint64_t, 16>;
+
+// Faixa restante de cada thread: a dona consome blocos do início,
+// as demais roubam a metade final do que resta
+struct alignas(64) FaixaTrabalho {
+    std::mutex mutex;
+    uint64_t inicio = 0;
+    uint64_t fim = 0;
+};
+
+bool obterFaixa(std::vector<FaixaTrabalho>& faixas, unsigned propria, uint64_t tamanhoFaixa,
+                Faixa& faixa, unsigned long long& roubos) {
+    FaixaTrabalho& minha = faixas[propria];
+    while (true) {
+        {
+            std::lock_guard<std::mutex> trava(minha.mutex);
+            if (minha.inicio < minha.fim) {
+                uint64_t fim = minha.fim - minha.inicio > tamanhoFaixa ? minha.inicio + tamanhoFaixa : minha.fim;
+                faixa = {minha.inicio, fim};
+                minha.inicio = fim;
+                return true;
+            }
+        }
+
+        Faixa roubada{0, 0};
+        for (size_t k = 1; k < faixas.size() && roubada.first == roubada.second; k++) {
+            FaixaTrabalho& vitima = faixas[(propria + k) % faixas.size()];
+            std::lock_guard<std::mutex> trava(vitima.mutex);
+            if (vitima.inicio < vitima.fim) {
+                uint64_t meio = vitima.inicio + (vitima.fim - vitima.inicio) / 2;
+                roubada = {meio, vitima.fim};
+                vitima.fim = meio;
+            }
+        }
+        if (roubada.first == roubada.second) return false;
+
+        roubos++;
+        std::lock_guard<std::mutex> trava(minha.mutex);
+        minha.inicio = roubada.first;
+        minha.fim = roubada.second;
+    }
+}
+
+// Espalha os bits de `indice` pelas posições livres da chave
+uint64_t espalhar(uint64_t indice, const std::vector<uint64_t>& bitsChave) {
+    uint64_t chave = 0;
+    for (size_t b = 0; indice != 0; b++, indice >>= 1) {
+        if (indice & 1) chave |= bitsChave[b];
+    }
+    return chave;
+}
+}
+
+Resultado buscarChaveDES(const Configuracao& configuracao) {
+    if (configuracao.bitsLivres < 0 || configuracao.bitsLivres > 56) {
+        throw std::invalid_argument("bitsLivres deve estar entre 0 e 56");
+    }
+
+    // Posições livres (não paridade) e sua contribuição para cada subchave
+    std::vector<uint64_t> bitsChave;
+    std::vector<Subchaves> deltas;
+    for (int bit = 0; bit < 64 && static_cast<int>(bitsChave.size()) < configuracao.bitsLivres; bit++) {
+        uint64_t mascara = 1ULL << bit;
+        if (mascara & MASCARA_PARIDADE) continue;
+        bitsChave.push_back(mascara);
+        deltas.push_back(DES::gerarSubchavesDES(mascara));
+    }
+    uint64_t mascaraLivre = 0;
+    for (uint64_t mascara : bitsChave) mascaraLivre |= mascara;
+    const uint64_t base = configuracao.chaveBase & ~mascaraLivre;
+
+    const uint64_t total = configuracao.bitsLivres == 0 ? 1 : (1ULL << configuracao.bitsLivres);
+    const uint64_t tamanhoFaixa = std::max<uint64_t>(1, configuracao.tamanhoFaixa);
+    const unsigned threads = std::max(1u, configuracao.threads);
+
+    // Cada thread começa com um trecho contíguo; desequilíbrios são corrigidos por roubo
+    std::vector<FaixaTrabalho> faixas(threads);
+    for (unsigned t = 0; t < threads; t++) {
+        faixas[t].inicio = total / threads * t + std::min<uint64_t>(t, total % threads);
+        faixas[t].fim = faixas[t].inicio + total / threads + (t < total % threads ? 1 : 0);
+    }
+
+    std::mutex mutexResultado;
+    Resultado resultado;
+    std::atomic<unsigned long long> roubos{0};
+
+    auto trabalhar = [&](unsigned id) {
+        unsigned long long roubosLocais = 0;
+        std::vector<uint64_t> encontradas;
+        Faixa faixa;
+        while (obterFaixa(faixas, id, tamanhoFaixa, faixa, roubosLocais)) {
+            auto [inicio, fim] = faixa;
+            uint64_t chave = base | espalhar(inicio ^ (inicio >> 1), bitsChave);
+            Subchaves subchaves = DES::gerarSubchavesDES(chave);
+
+            for (uint64_t i = inicio; i < fim; i++) {
+                if (i != inicio) {
+                    // gray(i) e gray(i - 1) diferem exatamente no bit ctz(i)
+                    int b = __builtin_ctzll(i);
+                    chave ^= bitsChave[b];
+                    if (configuracao.incremental) {
+                        for (int r = 0; r < 16; r++) subchaves[r] ^= deltas[b][r];
+                    } else {
+                        subchaves = DES::gerarSubchavesDES(chave);
+                    }
+                }
+                if (DES::criptografarBloco(configuracao.textoClaro, subchaves) == configuracao.textoCifrado) {
+                    encontradas.push_back(chave);
+                }
+            }
+        }
+        roubos += roubosLocais;
+        std::lock_guard<std::mutex> trava(mutexResultado);
+        resultado.chavesEncontradas.insert(resultado.chavesEncontradas.end(), encontradas.begin(), encontradas.end());
+    };
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<std::thread> trabalhadores;
+    for (unsigned t = 0; t < threads; t++) {
+        trabalhadores.emplace_back(trabalhar, t);
+    }
+    for (std::thread& trabalhador : trabalhadores) {
+        trabalhador.join();
+    }
+    std::chrono::duration<double> duracao = std::chrono::steady_clock::now() - inicio;
+
+    resultado.chavesTestadas = total;
+    resultado.roubos = roubos.load();
+    resultado.segundos = duracao.count();
+    std::sort(resultado.chavesEncontradas.begin(), resultado.chavesEncontradas.end());
+    return resultado;
+}
+}
@@ -0,0 +1,223 @@
+#include "carga.h"
+#include "des.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Carga {
+namespace {
+using Relogio = std::chrono::steady_clock;
+
+struct ResultadoConexao {
+    std::vector<double> latencias;
+    size_t erros = 0;
+    std::string falha;
+};
+
+// Fecha o socket ao sair do escopo, inclusive quando uma exceção é lançada
+struct Descritor {
+    int fd;
+    explicit Descritor(int fd) : fd(fd) {}
+    ~Descritor() { close(fd); }
+    Descritor(const Descritor&) = delete;
+    Descritor& operator=(const Descritor&) = delete;
+};
+
+int conectar(const std::string& caminho) {
+    sockaddr_un endereco{};
+    endereco.sun_family = AF_UNIX;
+    if (caminho.size() >= sizeof(endereco.sun_path)) {
+        throw std::invalid_argument("caminho do socket muito longo: " + caminho);
+    }
+    std::strcpy(endereco.sun_path, caminho.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    if (connect(fd, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) < 0) {
+        int erro = errno;
+        close(fd);
+        throw std::runtime_error("connect " + caminho + ": " + std::strerror(erro));
+    }
+    return fd;
+}
+
+void enviarTudo(int fd, const std::string& dados) {
+    size_t enviado = 0;
+    while (enviado < dados.size()) {
+        ssize_t n = send(fd, dados.data() + enviado, dados.size() - enviado, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("send: ") + std::strerror(errno));
+        }
+        enviado += n;
+    }
+}
+
+// Lê do socket até haver ao menos uma resposta completa no buffer
+void receberRespostas(int fd, std::string& buffer, std::vector<Protocolo::Resposta>& respostas) {
+    char bloco[64 * 1024];
+    while (true) {
+        size_t posicao = 0;
+        std::string_view quadro;
+        while (Protocolo::extrairQuadro(buffer, posicao, quadro)) {
+            Protocolo::Resposta resposta;
+            if (!Protocolo::desserializarResposta(quadro, resposta)) {
+                throw std::runtime_error("resposta malformada");
+            }
+            respostas.push_back(std::move(resposta));
+        }
+        buffer.erase(0, posicao);
+        if (!respostas.empty()) return;
+
+        ssize_t n = read(fd, bloco, sizeof(bloco));
+        if (n == 0) throw std::runtime_error("conexão encerrada pelo servidor");
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("read: ") + std::strerror(errno));
+        }
+        buffer.append(bloco, n);
+    }
+}
+
+// Para descriptografia, pede ao serviço uma cifra válida da mensagem
+std::string prepararDados(const Configuracao& configuracao, int fd, uint64_t chaveDES, std::string& buffer) {
+    using Protocolo::Algoritmo;
+    bool des = configuracao.algoritmo == Algoritmo::DES;
+    if (configuracao.operacao == Protocolo::Operacao::Criptografar) {
+        return des ? Protocolo::prefixarChaveDES(chaveDES, configuracao.mensagem) : configuracao.mensagem;
+    }
+    if (des) {
+        return Protocolo::prefixarChaveDES(chaveDES,
+            Protocolo::blocosParaBytes(DES::criptografarDES(configuracao.mensagem, chaveDES)));
+    }
+
+    Protocolo::Requisicao requisicao{0, configuracao.algoritmo, Protocolo::Operacao::Criptografar, configuracao.mensagem};
+    std::string quadro;
+    Protocolo::serializarRequisicao(requisicao, quadro);
+    enviarTudo(fd, quadro);
+    std::vector<Protocolo::Resposta> respostas;
+    receberRespostas(fd, buffer, respostas);
+    if (respostas.front().status != Protocolo::Status::Ok) {
+        throw std::runtime_error("falha ao obter cifra para descriptografia");
+    }
+    return respostas.front().dados;
+}
+
+// Confere o conteúdo da resposta: a descriptografia deve devolver a mensagem original
+// (com o preenchimento em zeros do DES) e a cifra deve ter o tamanho esperado
+bool respostaValida(const Configuracao& configuracao, const Protocolo::Resposta& resposta) {
+    if (resposta.status != Protocolo::Status::Ok) return false;
+
+    const std::string& mensagem = configuracao.mensagem;
+    size_t blocosDES = (mensagem.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    bool des = configuracao.algoritmo == Protocolo::Algoritmo::DES;
+    if (configuracao.operacao == Protocolo::Operacao::Descriptografar) {
+        if (!des) return resposta.dados == mensagem;
+        std::string esperado = mensagem;
+        esperado.resize(blocosDES * sizeof(uint64_t), '\0');
+        return resposta.dados == esperado;
+    }
+
+    switch (configuracao.algoritmo) {
+        case Protocolo::Algoritmo::DES: return resposta.dados.size() == blocosDES * sizeof(uint64_t);
+        case Protocolo::Algoritmo::RSA: return resposta.dados.size() == mensagem.size() * sizeof(int32_t);
+        case Protocolo::Algoritmo::GM: return resposta.dados.size() == mensagem.size() * 8 * sizeof(int32_t);
+    }
+    return false;
+}
+
+void executarConexao(const Configuracao& configuracao, uint64_t chaveDES, ResultadoConexao& resultado) {
+    try {
+        Descritor socketCliente(conectar(configuracao.caminhoSocket));
+        const int fd = socketCliente.fd;
+        std::string buffer;
+        std::string dados = prepararDados(configuracao, fd, chaveDES, buffer);
+
+        size_t total = configuracao.requisicoesPorConexao;
+        std::vector<Relogio::time_point> envio(total);
+        resultado.latencias.reserve(total);
+
+        size_t enviadas = 0, recebidas = 0;
+        std::string saida;
+        auto enviarAte = [&](size_t limite) {
+            saida.clear();
+            for (; enviadas < limite; enviadas++) {
+                Protocolo::Requisicao requisicao{static_cast<uint32_t>(enviadas), configuracao.algoritmo,
+                                                 configuracao.operacao, dados};
+                Protocolo::serializarRequisicao(requisicao, saida);
+                envio[enviadas] = Relogio::now();
+            }
+            enviarTudo(fd, saida);
+        };
+
+        enviarAte(std::min<size_t>(total, std::max(1u, configuracao.profundidade)));
+        std::vector<Protocolo::Resposta> respostas;
+        while (recebidas < total) {
+            respostas.clear();
+            receberRespostas(fd, buffer, respostas);
+            auto agora = Relogio::now();
+            for (const Protocolo::Resposta& resposta : respostas) {
+                if (resposta.id >= total) continue;
+                std::chrono::duration<double, std::micro> latencia = agora - envio[resposta.id];
+                resultado.latencias.push_back(latencia.count());
+                if (!respostaValida(configuracao, resposta)) resultado.erros++;
+            }
+            recebidas += respostas.size();
+            enviarAte(std::min(total, enviadas + respostas.size()));
+        }
+    } catch (const std::exception& e) {
+        resultado.falha = e.what();
+    }
+}
+
+double percentil(const std::vector<double>& ordenadas, double p) {
+    if (ordenadas.empty()) return 0;
+    size_t indice = static_cast<size_t>(std::ceil(p * ordenadas.size()));
+    return ordenadas[std::clamp<size_t>(indice, 1, ordenadas.size()) - 1];
+}
+}
+
+Resultado executarCarga(const Configuracao& configuracao) {
+    unsigned conexoes = std::max(1u, configuracao.conexoes);
+    std::vector<ResultadoConexao> parciais(conexoes);
+    std::vector<uint64_t> chaves(conexoes);
+    for (uint64_t& chave : chaves) {
+        chave = DES::gerarChaveDES(); // gerador compartilhado: chamar antes das threads
+    }
+
+    auto inicio = Relogio::now();
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < conexoes; i++) {
+        threads.emplace_back(executarConexao, std::cref(configuracao), chaves[i], std::ref(parciais[i]));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> duracao = Relogio::now() - inicio;
+
+    Resultado resultado;
+    std::vector<double> latencias;
+    for (ResultadoConexao& parcial : parciais) {
+        if (!parcial.falha.empty()) throw std::runtime_error(parcial.falha);
+        latencias.insert(latencias.end(), parcial.latencias.begin(), parcial.latencias.end());
+        resultado.erros += parcial.erros;
+    }
+    std::sort(latencias.begin(), latencias.end());
+
+    resultado.requisicoes = latencias.size();
+    resultado.segundos = duracao.count();
+    resultado.vazao = resultado.requisicoes / resultado.segundos;
+    resultado.p50 = percentil(latencias, 0.50);
+    resultado.p99 = percentil(latencias, 0.99);
+    resultado.p999 = percentil(latencias, 0.999);
+    return resultado;
+}
+}
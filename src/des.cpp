@@ -208,7 +208,10 @@ uint64_t descriptografarBloco(uint64_t bloco, const std::array<uint64_t, 16>& su
 }
 
 std::vector<uint64_t> criptografarDES(const std::string& mensagem, uint64_t chave) {
-    std::array<uint64_t, 16> subchaves = gerarSubchavesDES(chave);
+    return criptografarDES(mensagem, gerarSubchavesDES(chave));
+}
+
+std::vector<uint64_t> criptografarDES(const std::string& mensagem, const std::array<uint64_t, 16>& subchaves) {
     std::vector<bool> bits = Utils::stringParaBits(mensagem);
     
     while (bits.size() % 64 != 0) {
@@ -235,7 +238,10 @@ std::vector<uint64_t> criptografarDES(const std::string& mensagem, uint64_t chav
 }
 
 std::string descriptografarDES(const std::vector<uint64_t>& textoCifrado, uint64_t chave) {
-    std::array<uint64_t, 16> subchaves = gerarSubchavesDES(chave);
+    return descriptografarDES(textoCifrado, gerarSubchavesDES(chave));
+}
+
+std::string descriptografarDES(const std::vector<uint64_t>& textoCifrado, const std::array<uint64_t, 16>& subchaves) {
     std::vector<bool> bitsDecifrados;
     bitsDecifrados.reserve(textoCifrado.size() * 64);
     
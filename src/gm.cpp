@@ -2,8 +2,40 @@
 #include "rsa.h"
 #include "utils.h"
 #include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
 
 namespace GM {
+unsigned threadsEfetivas(size_t tamanho, unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    // Abaixo de 4096 cifras por thread o custo de criar threads domina
+    return static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, tamanho / 4096)));
+}
+
+namespace {
+// Divide [0, tamanho) em faixas contíguas, uma por thread
+template<typename Func>
+void paraCadaFaixa(size_t tamanho, unsigned threads, Func&& func) {
+    threads = threadsEfetivas(tamanho, threads);
+    if (threads <= 1) {
+        func(0u, size_t{0}, tamanho);
+        return;
+    }
+
+    std::vector<std::thread> trabalhadores;
+    size_t passo = (tamanho + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        size_t inicio = std::min(tamanho, t * passo);
+        size_t fim = std::min(tamanho, inicio + passo);
+        trabalhadores.emplace_back([&func, t, inicio, fim]() { func(t, inicio, fim); });
+    }
+    for (std::thread& trabalhador : trabalhadores) {
+        trabalhador.join();
+    }
+}
+}
+
 bool ehPrimo(int n) {
     if (n <= 1) return false;
     if (n <= 3) return true;
@@ -51,13 +83,17 @@ bool saoCoprimos(int a, int b) {
 }
 
 std::vector<int> criptografarGM(const std::string& mensagem, const std::tuple<int, int>& chavePublica) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    return criptografarGM(mensagem, chavePublica, gen);
+}
+
+std::vector<int> criptografarGM(const std::string& mensagem, const std::tuple<int, int>& chavePublica, std::mt19937& gen) {
     int n, y;
     std::tie(n, y) = chavePublica;
     std::vector<bool> bits = Utils::stringParaBits(mensagem);
     std::vector<int> textoCifrado;
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_int_distribution<> dis(1, n - 1);
     
     for (bool bit : bits) {
@@ -88,4 +124,61 @@ std::string descriptografarGM(const std::vector<int>& textoCifrado, const std::t
     
     return Utils::bitsParaString(bits);
 }
-}
\ No newline at end of file
+
+void xorCifras(std::vector<int>& cifras, const std::vector<int>& outras, const std::tuple<int, int>& chavePublica, unsigned threads) {
+    if (cifras.size() != outras.size()) {
+        throw std::invalid_argument("xorCifras: vetores de tamanhos diferentes");
+    }
+    const ReducaoBarrett reducao(std::get<0>(chavePublica));
+    int* c = cifras.data();
+    const int* d = outras.data();
+    paraCadaFaixa(cifras.size(), threads, [&](unsigned, size_t inicio, size_t fim) {
+        for (size_t i = inicio; i < fim; i++) {
+            c[i] = static_cast<int>(reducao.multiplicar(c[i], d[i]));
+        }
+    });
+}
+
+void xorMascara(std::vector<int>& cifras, const std::vector<uint8_t>& mascara, const std::tuple<int, int>& chavePublica, unsigned threads) {
+    if (cifras.size() != mascara.size()) {
+        throw std::invalid_argument("xorMascara: máscara e cifras de tamanhos diferentes");
+    }
+    const ReducaoBarrett reducao(std::get<0>(chavePublica));
+    const uint64_t y = std::get<1>(chavePublica);
+    int* c = cifras.data();
+    const uint8_t* m = mascara.data();
+    paraCadaFaixa(cifras.size(), threads, [&](unsigned, size_t inicio, size_t fim) {
+        for (size_t i = inicio; i < fim; i++) {
+            // Fator 1 ou y sem desvio: o laço multiplica sempre
+            uint64_t fator = 1 + (y - 1) * (m[i] & 1);
+            c[i] = static_cast<int>(reducao.multiplicar(c[i], fator));
+        }
+    });
+}
+
+void rerandomizar(std::vector<int>& cifras, const std::tuple<int, int>& chavePublica, std::mt19937& gen, unsigned threads) {
+    int n = std::get<0>(chavePublica);
+    const ReducaoBarrett reducao(n);
+    int* c = cifras.data();
+
+    // Cada thread efetivamente usada recebe seu próprio gerador, semeado a partir de `gen`
+    unsigned usadas = threadsEfetivas(cifras.size(), threads);
+    std::vector<std::mt19937> geradores;
+    geradores.reserve(usadas);
+    for (unsigned t = 0; t < usadas; t++) {
+        geradores.emplace_back(gen());
+    }
+
+    paraCadaFaixa(cifras.size(), usadas, [&](unsigned t, size_t inicio, size_t fim) {
+        std::mt19937& local = geradores[t];
+        std::uniform_int_distribution<> dis(1, n - 1);
+        for (size_t i = inicio; i < fim; i++) {
+            int r;
+            do {
+                r = dis(local);
+            } while (!saoCoprimos(r, n));
+            c[i] = static_cast<int>(reducao.multiplicar(c[i], reducao.multiplicar(r, r)));
+        }
+    });
+}
+}
@@ -2,7 +2,19 @@
 #include "rsa.h"
 #include "des.h"
 #include "gm.h"
+#include "servidor.h"
+#include "carga.h"
+#include "busca.h"
+#include <climits>
+#include <csignal>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
 
 using namespace std;
 
@@ -29,7 +41,7 @@ void imprimirResultados(const string& algoritmo, double tempoGeracaoChaves,
          << "Tamanho da cifra: " << tamanhoCifrado << " bytes" << endl << endl;
 }
 
-int main() {
+int executarBenchmark() {
     string mensagem = "Teste de diferentes algoritmos de criptografia";
     int tamanhoMensagem = mensagem.size();
     const int NUM_RODADAS = 10000;
@@ -138,4 +150,325 @@ int main() {
     cout << "-----------------------------------------------------------------" << endl;
     
     return 0;
-}
\ No newline at end of file
+}
+
+// Lê opções no formato "--nome valor" a partir de argv[inicio]
+map<string, string> lerOpcoes(int argc, char* argv[], int inicio) {
+    map<string, string> opcoes;
+    for (int i = inicio; i < argc; i++) {
+        string nome = argv[i];
+        if (nome.rfind("--", 0) != 0 || i + 1 >= argc) {
+            throw invalid_argument("opção inválida: " + nome);
+        }
+        opcoes[nome.substr(2)] = argv[++i];
+    }
+    return opcoes;
+}
+
+// Converte o valor de --nome, exigindo que esteja em [minimo, maximo]
+long long converterNumero(const string& nome, const string& texto, long long minimo, long long maximo) {
+    long long valor;
+    size_t lidos = 0;
+    try {
+        valor = stoll(texto, &lidos);
+    } catch (const exception&) {
+        throw invalid_argument("valor inválido para --" + nome + ": " + texto);
+    }
+    if (lidos != texto.size()) {
+        throw invalid_argument("valor inválido para --" + nome + ": " + texto);
+    }
+    if (valor < minimo || valor > maximo) {
+        throw invalid_argument("--" + nome + " deve estar entre " + to_string(minimo) + " e " + to_string(maximo));
+    }
+    return valor;
+}
+
+long long lerNumero(const map<string, string>& opcoes, const string& nome, long long padrao,
+                    long long minimo = LLONG_MIN, long long maximo = LLONG_MAX) {
+    auto it = opcoes.find(nome);
+    if (it == opcoes.end()) return padrao;
+    return converterNumero(nome, it->second, minimo, maximo);
+}
+
+// Converte uma lista "1,8,32" em números
+vector<long long> lerLista(const map<string, string>& opcoes, const string& nome, const string& padrao,
+                           long long minimo = LLONG_MIN, long long maximo = LLONG_MAX) {
+    auto it = opcoes.find(nome);
+    vector<long long> valores;
+    stringstream entrada(it == opcoes.end() ? padrao : it->second);
+    string item;
+    while (getline(entrada, item, ',')) {
+        valores.push_back(converterNumero(nome, item, minimo, maximo));
+    }
+    return valores;
+}
+
+// Limites aceitos nas opções de linha de comando
+constexpr long long MAX_THREADS = 1024;
+constexpr long long MAX_ESPERA_MICROS = 60'000'000;
+
+Servidor::ServicoCriptografia* servicoAtivo = nullptr;
+
+void tratarSinal(int) {
+    if (servicoAtivo) servicoAtivo->parar();
+}
+
+int executarServidor(const map<string, string>& opcoes) {
+    Servidor::Configuracao configuracao;
+    if (opcoes.count("socket")) configuracao.caminhoSocket = opcoes.at("socket");
+    configuracao.tamanhoMaximoLote = lerNumero(opcoes, "lote", configuracao.tamanhoMaximoLote, 1, 1 << 20);
+    configuracao.esperaMaximaMicros = lerNumero(opcoes, "espera", configuracao.esperaMaximaMicros, 0, MAX_ESPERA_MICROS);
+    configuracao.trabalhadores = lerNumero(opcoes, "trabalhadores", configuracao.trabalhadores, 0, MAX_THREADS);
+
+    Servidor::ServicoCriptografia servico(configuracao);
+    servicoAtivo = &servico;
+    signal(SIGINT, tratarSinal);
+    signal(SIGTERM, tratarSinal);
+
+    cout << "Escutando em " << configuracao.caminhoSocket
+         << " (lote máximo=" << configuracao.tamanhoMaximoLote
+         << ", espera máxima=" << configuracao.esperaMaximaMicros << " μs)" << endl;
+    servico.executar();
+    servicoAtivo = nullptr;
+
+    Servidor::Estatisticas estatisticas = servico.estatisticas();
+    cout << "Requisições atendidas: " << estatisticas.requisicoes << endl
+         << "Lotes processados: " << estatisticas.lotes << endl;
+    return 0;
+}
+
+void imprimirCarga(const Carga::Resultado& resultado) {
+    cout << fixed << setprecision(1)
+         << "Requisições: " << resultado.requisicoes << " (" << resultado.erros << " erros) em "
+         << resultado.segundos << " s" << endl
+         << "Vazão: " << resultado.vazao << " req/s" << endl
+         << "Latência p50/p99/p999: " << resultado.p50 << " / " << resultado.p99 << " / "
+         << resultado.p999 << " μs" << endl;
+}
+
+int executarCarga(const map<string, string>& opcoes) {
+    Carga::Configuracao configuracao;
+    if (opcoes.count("socket")) configuracao.caminhoSocket = opcoes.at("socket");
+    if (opcoes.count("mensagem")) configuracao.mensagem = opcoes.at("mensagem");
+    if (opcoes.count("algoritmo") && !Protocolo::algoritmoPorNome(opcoes.at("algoritmo"), configuracao.algoritmo)) {
+        throw invalid_argument("algoritmo desconhecido: " + opcoes.at("algoritmo"));
+    }
+    if (opcoes.count("operacao")) {
+        const string& operacao = opcoes.at("operacao");
+        if (operacao == "decripto") configuracao.operacao = Protocolo::Operacao::Descriptografar;
+        else if (operacao != "cripto") throw invalid_argument("operação desconhecida: " + operacao);
+    }
+    configuracao.conexoes = lerNumero(opcoes, "conexoes", configuracao.conexoes, 1, MAX_THREADS);
+    configuracao.profundidade = lerNumero(opcoes, "profundidade", configuracao.profundidade, 1, 1 << 16);
+    configuracao.requisicoesPorConexao = lerNumero(opcoes, "requisicoes", configuracao.requisicoesPorConexao, 1, 100'000'000);
+
+    vector<long long> lotes = lerLista(opcoes, "lotes", "32", 1, 1 << 20);
+    vector<long long> esperas = lerLista(opcoes, "esperas", "200", 0, MAX_ESPERA_MICROS);
+    long long trabalhadores = lerNumero(opcoes, "trabalhadores", 0, 0, MAX_THREADS);
+
+    cout << "Carga " << Protocolo::nomeAlgoritmo(configuracao.algoritmo) << ": "
+         << configuracao.conexoes << " conexões x " << configuracao.profundidade << " em voo" << endl;
+
+    // Sem --lotes/--esperas, mede um serviço já em execução
+    if (!opcoes.count("lotes") && !opcoes.count("esperas")) {
+        imprimirCarga(Carga::executarCarga(configuracao));
+        return 0;
+    }
+
+    // Varredura: sobe um serviço embutido para cada combinação de lote e espera
+    Servidor::Configuracao configuracaoServidor;
+    configuracaoServidor.caminhoSocket = "/tmp/cryptmark-varredura-" + to_string(getpid()) + ".sock";
+    configuracaoServidor.trabalhadores = trabalhadores;
+    configuracao.caminhoSocket = configuracaoServidor.caminhoSocket;
+
+    cout << setw(8) << "lote" << setw(12) << "espera(μs)" << setw(14) << "req/s"
+         << setw(12) << "p50(μs)" << setw(12) << "p99(μs)" << setw(12) << "p999(μs)"
+         << setw(14) << "lote médio" << setw(8) << "erros" << endl;
+    for (long long lote : lotes) {
+        for (long long espera : esperas) {
+            configuracaoServidor.tamanhoMaximoLote = lote;
+            configuracaoServidor.esperaMaximaMicros = espera;
+            Servidor::ServicoCriptografia servico(configuracaoServidor);
+            thread laco([&]() { servico.executar(); });
+
+            Carga::Resultado resultado;
+            try {
+                resultado = Carga::executarCarga(configuracao);
+            } catch (...) {
+                servico.parar();
+                laco.join();
+                throw;
+            }
+            servico.parar();
+            laco.join();
+
+            Servidor::Estatisticas estatisticas = servico.estatisticas();
+            double loteMedio = estatisticas.lotes ? estatisticas.requisicoes / (double)estatisticas.lotes : 0;
+            cout << fixed << setprecision(1)
+                 << setw(8) << lote << setw(12) << espera << setw(14) << resultado.vazao
+                 << setw(12) << resultado.p50 << setw(12) << resultado.p99 << setw(12) << resultado.p999
+                 << setw(14) << loteMedio << setw(8) << resultado.erros << endl;
+        }
+    }
+    return 0;
+}
+
+// Mede operações homomórficas GM contra o caminho descriptografar-operar-criptografar
+int executarHomomorficoGM(const map<string, string>& opcoes) {
+    const size_t bytes = lerNumero(opcoes, "bytes", 4096, 1, 1 << 24);
+    const unsigned threads = lerNumero(opcoes, "threads", 1, 0, MAX_THREADS);
+    const int rodadas = lerNumero(opcoes, "rodadas", 20, 1, 1'000'000);
+    const size_t bits = bytes * 8;
+
+    mt19937 gen(random_device{}());
+    uniform_int_distribution<> byteAleatorio(0, 255);
+    string a(bytes, '\0'), b(bytes, '\0');
+    for (size_t i = 0; i < bytes; i++) {
+        a[i] = static_cast<char>(byteAleatorio(gen));
+        b[i] = static_cast<char>(byteAleatorio(gen));
+    }
+    vector<bool> bitsMascara = Utils::stringParaBits(b);
+    vector<uint8_t> mascara(bitsMascara.begin(), bitsMascara.end());
+
+    auto [chavePublica, chavePrivada] = GM::gerarChavesGM();
+    const vector<int> cifraA = GM::criptografarGM(a, chavePublica, gen);
+    const vector<int> cifraB = GM::criptografarGM(b, chavePublica, gen);
+
+    string esperado(bytes, '\0');
+    for (size_t i = 0; i < bytes; i++) {
+        esperado[i] = static_cast<char>(a[i] ^ b[i]);
+    }
+
+    long long tempoXor = 0, tempoMascara = 0, tempoRerandomizar = 0, tempoBase = 0;
+    bool correto = true;
+    for (int rodada = 0; rodada < rodadas; rodada++) {
+        vector<int> c = cifraA;
+        tempoXor += Utils::medirTempo([&]() { GM::xorCifras(c, cifraB, chavePublica, threads); });
+        correto &= GM::descriptografarGM(c, chavePrivada) == esperado;
+
+        c = cifraA;
+        tempoMascara += Utils::medirTempo([&]() { GM::xorMascara(c, mascara, chavePublica, threads); });
+        correto &= GM::descriptografarGM(c, chavePrivada) == esperado;
+
+        tempoRerandomizar += Utils::medirTempo([&]() { GM::rerandomizar(c, chavePublica, gen, threads); });
+        correto &= GM::descriptografarGM(c, chavePrivada) == esperado;
+
+        // Linha de base: descriptografa, aplica a máscara em claro e criptografa de novo
+        vector<int> base;
+        tempoBase += Utils::medirTempo([&]() {
+            string claro = GM::descriptografarGM(cifraA, chavePrivada);
+            for (size_t i = 0; i < bytes; i++) {
+                claro[i] = static_cast<char>(claro[i] ^ b[i]);
+            }
+            base = GM::criptografarGM(claro, chavePublica, gen);
+        });
+        correto &= GM::descriptografarGM(base, chavePrivada) == esperado;
+    }
+
+    auto opsPorSegundo = [&](long long micros) {
+        return micros > 0 ? bits * (double)rodadas / (micros / 1e6) : 0.0;
+    };
+    double base = opsPorSegundo(tempoBase);
+
+    cout << "Goldwasser-Micali homomórfico: " << bits << " bits x " << rodadas << " rodadas, "
+         << GM::threadsEfetivas(bits, threads) << " thread(s)" << endl
+         << "-----------------------------------------------------------------" << endl
+         << fixed << setprecision(0);
+    auto imprimir = [&](const string& nome, long long micros) {
+        double ops = opsPorSegundo(micros);
+        cout << nome << ": " << ops << " bits/s";
+        if (base > 0) cout << "  (" << setprecision(1) << ops / base << "x)" << setprecision(0);
+        cout << endl;
+    };
+    imprimir("XOR entre cifras", tempoXor);
+    imprimir("XOR com máscara em claro", tempoMascara);
+    imprimir("Rerrandomização", tempoRerandomizar);
+    imprimir("Descriptografar-operar-criptografar", tempoBase);
+    cout << "Resultados " << (correto ? "conferem" : "DIVERGEM") << " com o XOR em claro" << endl;
+    return correto ? 0 : 1;
+}
+
+// Busca exaustiva por par conhecido em um espaço de chaves DES restrito
+int executarBuscaDES(const map<string, string>& opcoes) {
+    Busca::Configuracao configuracao;
+    configuracao.bitsLivres = lerNumero(opcoes, "bits", configuracao.bitsLivres, 0, 56);
+    configuracao.tamanhoFaixa = lerNumero(opcoes, "faixa", configuracao.tamanhoFaixa, 1, LLONG_MAX);
+
+    vector<long long> listaThreads;
+    if (opcoes.count("threads")) {
+        listaThreads = lerLista(opcoes, "threads", "", 1, MAX_THREADS);
+    } else {
+        long long nucleos = max(1u, thread::hardware_concurrency());
+        for (long long t = 1; t < nucleos; t *= 2) listaThreads.push_back(t);
+        listaThreads.push_back(nucleos);
+    }
+
+    mt19937_64 gen(random_device{}());
+    uint64_t chave = DES::gerarChaveDES();
+    configuracao.textoClaro = gen();
+    configuracao.textoCifrado = DES::criptografarBloco(configuracao.textoClaro, DES::gerarSubchavesDES(chave));
+    // Apenas os bits fixos da chave são usados; os livres são zerados pela busca
+    configuracao.chaveBase = chave;
+
+    cout << "Busca DES por texto conhecido: " << configuracao.bitsLivres << " bits livres ("
+         << (1ULL << configuracao.bitsLivres) << " chaves)" << endl
+         << "-----------------------------------------------------------------" << endl
+         << fixed << setprecision(0);
+
+    auto contemChave = [&](const Busca::Resultado& resultado) {
+        for (uint64_t candidata : resultado.chavesEncontradas) {
+            if (((candidata ^ chave) & ~Busca::MASCARA_PARIDADE) == 0) return true;
+        }
+        return false;
+    };
+
+    // Referência sem atualização incremental, para expor o custo do escalonamento
+    configuracao.threads = 1;
+    configuracao.incremental = false;
+    Busca::Resultado completo = Busca::buscarChaveDES(configuracao);
+    double vazaoCompleta = completo.chavesTestadas / completo.segundos;
+    cout << "Escalonamento completo por chave (1 thread): " << vazaoCompleta << " chaves/s" << endl;
+
+    // Base da curva de escalabilidade: sempre uma execução incremental com 1 thread
+    configuracao.incremental = true;
+    Busca::Resultado umaThread = Busca::buscarChaveDES(configuracao);
+    double vazaoUmaThread = umaThread.chavesTestadas / umaThread.segundos;
+    cout << "Incremental, 1 thread (base): " << vazaoUmaThread << " chaves/s" << endl;
+
+    bool encontrada = contemChave(completo) && contemChave(umaThread);
+    for (long long threads : listaThreads) {
+        if (threads == 1) continue;
+        configuracao.threads = threads;
+        Busca::Resultado resultado = Busca::buscarChaveDES(configuracao);
+        double vazao = resultado.chavesTestadas / resultado.segundos;
+        encontrada &= contemChave(resultado) && resultado.chavesEncontradas == completo.chavesEncontradas;
+        // Threads além dos núcleos disponíveis não somam capacidade
+        long long nucleosUsados = min<long long>(threads, max(1u, thread::hardware_concurrency()));
+
+        cout << "Incremental, " << threads << " thread(s): " << vazao << " chaves/s, "
+             << vazao / nucleosUsados << " chaves/s por núcleo, aceleração "
+             << setprecision(2) << vazao / vazaoUmaThread << "x, " << resultado.roubos << " roubos"
+             << setprecision(0) << endl;
+    }
+
+    cout << "Chaves candidatas: " << completo.chavesEncontradas.size() << endl
+         << "Chave correta " << (encontrada ? "encontrada" : "NÃO encontrada") << endl;
+    return encontrada ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    string modo = argc > 1 ? argv[1] : "";
+    try {
+        if (modo.empty()) return executarBenchmark();
+        if (modo == "servidor") return executarServidor(lerOpcoes(argc, argv, 2));
+        if (modo == "carga") return executarCarga(lerOpcoes(argc, argv, 2));
+        if (modo == "gm-homomorfico") return executarHomomorficoGM(lerOpcoes(argc, argv, 2));
+        if (modo == "busca-des") return executarBuscaDES(lerOpcoes(argc, argv, 2));
+    } catch (const exception& e) {
+        cerr << "Erro: " << e.what() << endl;
+        return 1;
+    }
+
+    cerr << "Uso: " << argv[0] << " [servidor|carga|gm-homomorfico|busca-des] [--opcao valor ...]" << endl;
+    return 1;
+}
@@ -0,0 +1,130 @@
+#include "protocolo.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace Protocolo {
+namespace {
+template<typename T>
+void anexar(std::string& saida, T valor) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &valor, sizeof(T));
+    saida.append(bytes, sizeof(T));
+}
+
+template<typename T>
+T ler(const char* origem) {
+    T valor;
+    std::memcpy(&valor, origem, sizeof(T));
+    return valor;
+}
+}
+
+void serializarRequisicao(const Requisicao& requisicao, std::string& saida) {
+    anexar<uint32_t>(saida, static_cast<uint32_t>(6 + requisicao.dados.size()));
+    anexar<uint32_t>(saida, requisicao.id);
+    anexar<uint8_t>(saida, static_cast<uint8_t>(requisicao.algoritmo));
+    anexar<uint8_t>(saida, static_cast<uint8_t>(requisicao.operacao));
+    saida += requisicao.dados;
+}
+
+void serializarResposta(const Resposta& resposta, std::string& saida) {
+    anexar<uint32_t>(saida, static_cast<uint32_t>(5 + resposta.dados.size()));
+    anexar<uint32_t>(saida, resposta.id);
+    anexar<uint8_t>(saida, static_cast<uint8_t>(resposta.status));
+    saida += resposta.dados;
+}
+
+bool extrairQuadro(const std::string& buffer, size_t& posicao, std::string_view& quadro) {
+    if (buffer.size() - posicao < sizeof(uint32_t)) return false;
+    uint32_t tamanho = ler<uint32_t>(buffer.data() + posicao);
+    if (tamanho > TAMANHO_MAXIMO_QUADRO) {
+        throw std::runtime_error("quadro excede o tamanho máximo");
+    }
+    if (buffer.size() - posicao - sizeof(uint32_t) < tamanho) return false;
+    quadro = std::string_view(buffer.data() + posicao + sizeof(uint32_t), tamanho);
+    posicao += sizeof(uint32_t) + tamanho;
+    return true;
+}
+
+bool desserializarRequisicao(std::string_view quadro, Requisicao& requisicao) {
+    if (quadro.size() < 6) return false;
+    // Algoritmo/operação desconhecidos não invalidam o quadro: quem processa responde com erro
+    requisicao.id = ler<uint32_t>(quadro.data());
+    requisicao.algoritmo = static_cast<Algoritmo>(static_cast<uint8_t>(quadro[4]));
+    requisicao.operacao = static_cast<Operacao>(static_cast<uint8_t>(quadro[5]));
+    requisicao.dados.assign(quadro.substr(6));
+    return true;
+}
+
+bool desserializarResposta(std::string_view quadro, Resposta& resposta) {
+    if (quadro.size() < 5) return false;
+    resposta.id = ler<uint32_t>(quadro.data());
+    resposta.status = static_cast<Status>(quadro[4]);
+    resposta.dados.assign(quadro.substr(5));
+    return true;
+}
+
+std::string blocosParaBytes(const std::vector<uint64_t>& blocos) {
+    std::string bytes;
+    bytes.reserve(blocos.size() * sizeof(uint64_t));
+    for (uint64_t bloco : blocos) {
+        anexar<uint64_t>(bytes, bloco);
+    }
+    return bytes;
+}
+
+std::vector<uint64_t> bytesParaBlocos(std::string_view bytes) {
+    std::vector<uint64_t> blocos;
+    blocos.reserve(bytes.size() / sizeof(uint64_t));
+    for (size_t i = 0; i + sizeof(uint64_t) <= bytes.size(); i += sizeof(uint64_t)) {
+        blocos.push_back(ler<uint64_t>(bytes.data() + i));
+    }
+    return blocos;
+}
+
+std::string inteirosParaBytes(const std::vector<int>& valores) {
+    std::string bytes;
+    bytes.reserve(valores.size() * sizeof(int32_t));
+    for (int valor : valores) {
+        anexar<int32_t>(bytes, valor);
+    }
+    return bytes;
+}
+
+std::vector<int> bytesParaInteiros(std::string_view bytes) {
+    std::vector<int> valores;
+    valores.reserve(bytes.size() / sizeof(int32_t));
+    for (size_t i = 0; i + sizeof(int32_t) <= bytes.size(); i += sizeof(int32_t)) {
+        valores.push_back(ler<int32_t>(bytes.data() + i));
+    }
+    return valores;
+}
+
+std::string prefixarChaveDES(uint64_t chave, std::string_view dados) {
+    std::string resultado;
+    resultado.reserve(sizeof(uint64_t) + dados.size());
+    anexar<uint64_t>(resultado, chave);
+    resultado += dados;
+    return resultado;
+}
+
+uint64_t lerChaveDES(std::string_view dados) {
+    return ler<uint64_t>(dados.data());
+}
+
+bool algoritmoPorNome(std::string_view nome, Algoritmo& algoritmo) {
+    if (nome == "des") { algoritmo = Algoritmo::DES; return true; }
+    if (nome == "rsa") { algoritmo = Algoritmo::RSA; return true; }
+    if (nome == "gm") { algoritmo = Algoritmo::GM; return true; }
+    return false;
+}
+
+const char* nomeAlgoritmo(Algoritmo algoritmo) {
+    switch (algoritmo) {
+        case Algoritmo::DES: return "DES";
+        case Algoritmo::RSA: return "RSA";
+        case Algoritmo::GM: return "Goldwasser-Micali";
+    }
+    return "?";
+}
+}
@@ -0,0 +1,441 @@
+#include "servidor.h"
+#include "des.h"
+#include "rsa.h"
+#include "gm.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Servidor {
+namespace {
+// Identificadores reservados no campo data.u64 do epoll
+constexpr uint64_t ID_ESCUTA = UINT64_MAX;
+constexpr uint64_t ID_DESPERTAR = UINT64_MAX - 1;
+
+std::runtime_error erroSistema(const std::string& contexto) {
+    return std::runtime_error(contexto + ": " + std::strerror(errno));
+}
+
+void registrar(int fdEpoll, int fd, uint64_t id, uint32_t eventos, int operacao = EPOLL_CTL_ADD) {
+    epoll_event evento{};
+    evento.events = eventos;
+    evento.data.u64 = id;
+    if (epoll_ctl(fdEpoll, operacao, fd, &evento) < 0) {
+        throw erroSistema("epoll_ctl");
+    }
+}
+
+void sinalizar(int fd) {
+    uint64_t um = 1;
+    // Um eventfd saturado já está sinalizado; a falha pode ser ignorada
+    [[maybe_unused]] ssize_t n = write(fd, &um, sizeof(um));
+}
+}
+
+ServicoCriptografia::ServicoCriptografia(const Configuracao& configuracao) : configuracao(configuracao) {
+    if (this->configuracao.tamanhoMaximoLote == 0) this->configuracao.tamanhoMaximoLote = 1;
+    if (this->configuracao.trabalhadores == 0) {
+        this->configuracao.trabalhadores = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::tie(chavePublicaRSA, chavePrivadaRSA) = RSA::gerarChavesRSA(9967, 9973);
+    std::tie(chavePublicaGM, chavePrivadaGM) = GM::gerarChavesGM();
+
+    sockaddr_un endereco{};
+    endereco.sun_family = AF_UNIX;
+    if (this->configuracao.caminhoSocket.size() >= sizeof(endereco.sun_path)) {
+        throw std::invalid_argument("caminho do socket muito longo: " + this->configuracao.caminhoSocket);
+    }
+    std::strcpy(endereco.sun_path, this->configuracao.caminhoSocket.c_str());
+
+    fdEscuta = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fdEscuta < 0) throw erroSistema("socket");
+
+    // Desfaz a inicialização parcial: o destrutor não roda se o construtor lançar
+    bool vinculado = false;
+    auto liberar = [&]() {
+        int erro = errno;
+        close(fdEscuta);
+        if (fdEpoll >= 0) close(fdEpoll);
+        if (fdDespertar >= 0) close(fdDespertar);
+        if (vinculado) unlink(endereco.sun_path);
+        errno = erro;
+    };
+
+    unlink(endereco.sun_path);
+    if (bind(fdEscuta, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) < 0) {
+        liberar();
+        throw erroSistema("bind " + this->configuracao.caminhoSocket);
+    }
+    vinculado = true;
+    if (listen(fdEscuta, SOMAXCONN) < 0) {
+        liberar();
+        throw erroSistema("listen");
+    }
+
+    fdEpoll = epoll_create1(EPOLL_CLOEXEC);
+    fdDespertar = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fdEpoll < 0 || fdDespertar < 0) {
+        liberar();
+        throw erroSistema("epoll/eventfd");
+    }
+    try {
+        registrar(fdEpoll, fdEscuta, ID_ESCUTA, EPOLLIN);
+        registrar(fdEpoll, fdDespertar, ID_DESPERTAR, EPOLLIN);
+    } catch (...) {
+        liberar();
+        throw;
+    }
+}
+
+ServicoCriptografia::~ServicoCriptografia() {
+    for (auto& [id, conexao] : conexoes) {
+        close(conexao.fd);
+    }
+    close(fdDespertar);
+    close(fdEpoll);
+    close(fdEscuta);
+    unlink(configuracao.caminhoSocket.c_str());
+}
+
+void ServicoCriptografia::parar() {
+    pararSolicitado.store(true);
+    sinalizar(fdDespertar);
+}
+
+Estatisticas ServicoCriptografia::estatisticas() const {
+    return {totalRequisicoes.load(), totalLotes.load()};
+}
+
+void ServicoCriptografia::executar() {
+    {
+        std::lock_guard<std::mutex> trava(mutexFila);
+        encerrandoTrabalhadores = false;
+    }
+
+    try {
+        for (unsigned i = 0; i < configuracao.trabalhadores; i++) {
+            trabalhadores.emplace_back(&ServicoCriptografia::cicloTrabalhador, this);
+        }
+
+        epoll_event eventos[64];
+        while (!pararSolicitado.load()) {
+            int n = epoll_wait(fdEpoll, eventos, 64, -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            for (int i = 0; i < n; i++) {
+                uint64_t id = eventos[i].data.u64;
+                uint32_t ocorridos = eventos[i].events;
+                if (id == ID_ESCUTA) {
+                    aceitarConexoes();
+                } else if (id == ID_DESPERTAR) {
+                    uint64_t contador;
+                    while (read(fdDespertar, &contador, sizeof(contador)) > 0) {}
+                    entregarRespostas();
+                } else {
+                    if (ocorridos & (EPOLLIN | EPOLLHUP | EPOLLERR)) lerConexao(id);
+                    if (ocorridos & EPOLLOUT) escreverConexao(id);
+                }
+            }
+        }
+    } catch (...) {
+        encerrarTrabalhadores();
+        throw;
+    }
+    encerrarTrabalhadores();
+}
+
+void ServicoCriptografia::encerrarTrabalhadores() {
+    {
+        std::lock_guard<std::mutex> trava(mutexFila);
+        encerrandoTrabalhadores = true;
+    }
+    cvFila.notify_all();
+    for (std::thread& trabalhador : trabalhadores) {
+        trabalhador.join();
+    }
+    trabalhadores.clear();
+}
+
+void ServicoCriptografia::aceitarConexoes() {
+    while (true) {
+        int fd = accept4(fdEscuta, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return; // EAGAIN ou falha transitória
+        }
+        uint64_t id = proximaConexao++;
+        conexoes[id].fd = fd;
+        registrar(fdEpoll, fd, id, EPOLLIN);
+    }
+}
+
+void ServicoCriptografia::lerConexao(uint64_t id) {
+    auto it = conexoes.find(id);
+    if (it == conexoes.end()) return;
+    Conexao& conexao = it->second;
+
+    // Já meio-fechada, só chega aqui por EPOLLHUP/EPOLLERR: o cliente não lê mais
+    if (conexao.leituraEncerrada) {
+        fecharConexao(id);
+        return;
+    }
+
+    char buffer[64 * 1024];
+    bool fimLeitura = false;
+    while (true) {
+        ssize_t n = read(conexao.fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            conexao.entrada.append(buffer, n);
+        } else if (n == 0) {
+            fimLeitura = true;
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            fecharConexao(id);
+            return;
+        }
+    }
+
+    // Enfileira de uma vez todos os quadros completos recebidos nesta leitura
+    std::vector<Pendente> recebidas;
+    auto agora = Relogio::now();
+    size_t posicao = 0;
+    std::string_view quadro;
+    try {
+        while (Protocolo::extrairQuadro(conexao.entrada, posicao, quadro)) {
+            Pendente pendente{id, {}, agora};
+            if (!Protocolo::desserializarRequisicao(quadro, pendente.requisicao)) {
+                fimLeitura = true;
+                break;
+            }
+            recebidas.push_back(std::move(pendente));
+        }
+    } catch (const std::runtime_error&) {
+        fimLeitura = true;
+    }
+    conexao.entrada.erase(0, posicao);
+
+    if (!recebidas.empty()) {
+        conexao.emAndamento += recebidas.size();
+        bool acordar;
+        {
+            std::lock_guard<std::mutex> trava(mutexFila);
+            bool estavaVazia = fila.empty();
+            for (Pendente& pendente : recebidas) {
+                fila.push_back(std::move(pendente));
+            }
+            acordar = estavaVazia || fila.size() >= configuracao.tamanhoMaximoLote;
+        }
+        if (acordar) cvFila.notify_one();
+    }
+
+    // Meio-fechamento: para de ler, mas responde ao que já foi aceito antes de fechar
+    if (fimLeitura) {
+        conexao.leituraEncerrada = true;
+        conexao.entrada.clear();
+        if (conexao.emAndamento == 0 && conexao.saida.empty()) {
+            fecharConexao(id);
+        } else {
+            atualizarInteresse(id, conexao);
+        }
+    }
+}
+
+void ServicoCriptografia::escreverConexao(uint64_t id) {
+    auto it = conexoes.find(id);
+    if (it == conexoes.end()) return;
+    Conexao& conexao = it->second;
+
+    size_t enviado = 0;
+    while (enviado < conexao.saida.size()) {
+        ssize_t n = send(conexao.fd, conexao.saida.data() + enviado, conexao.saida.size() - enviado, MSG_NOSIGNAL);
+        if (n > 0) {
+            enviado += n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            fecharConexao(id);
+            return;
+        }
+    }
+    conexao.saida.erase(0, enviado);
+
+    if (conexao.leituraEncerrada && conexao.emAndamento == 0 && conexao.saida.empty()) {
+        fecharConexao(id);
+        return;
+    }
+    if (conexao.saida.empty() == conexao.aguardandoEscrita) {
+        conexao.aguardandoEscrita = !conexao.saida.empty();
+        atualizarInteresse(id, conexao);
+    }
+}
+
+void ServicoCriptografia::atualizarInteresse(uint64_t id, Conexao& conexao) {
+    uint32_t eventos = 0;
+    if (!conexao.leituraEncerrada) eventos |= EPOLLIN;
+    if (conexao.aguardandoEscrita) eventos |= EPOLLOUT;
+    registrar(fdEpoll, conexao.fd, id, eventos, EPOLL_CTL_MOD);
+}
+
+void ServicoCriptografia::fecharConexao(uint64_t id) {
+    auto it = conexoes.find(id);
+    if (it == conexoes.end()) return;
+    epoll_ctl(fdEpoll, EPOLL_CTL_DEL, it->second.fd, nullptr);
+    close(it->second.fd);
+    conexoes.erase(it);
+}
+
+void ServicoCriptografia::entregarRespostas() {
+    std::vector<Concluida> prontas;
+    {
+        std::lock_guard<std::mutex> trava(mutexConcluidas);
+        prontas.swap(concluidas);
+    }
+
+    std::vector<uint64_t> afetadas;
+    for (Concluida& concluida : prontas) {
+        auto it = conexoes.find(concluida.conexao);
+        if (it == conexoes.end()) continue; // cliente já desconectou
+        if (it->second.saida.empty()) afetadas.push_back(concluida.conexao);
+        it->second.saida += concluida.quadro;
+        it->second.emAndamento--;
+    }
+    for (uint64_t id : afetadas) {
+        escreverConexao(id);
+    }
+}
+
+std::vector<ServicoCriptografia::Pendente> ServicoCriptografia::coletarLote() {
+    const auto espera = std::chrono::microseconds(configuracao.esperaMaximaMicros);
+    std::unique_lock<std::mutex> trava(mutexFila);
+
+    // Aguarda até o lote encher ou a requisição mais antiga atingir a espera máxima
+    while (true) {
+        cvFila.wait(trava, [&] { return encerrandoTrabalhadores || !fila.empty(); });
+        if (fila.empty()) return {};
+        auto prazo = fila.front().chegada + espera;
+        if (fila.size() >= configuracao.tamanhoMaximoLote || encerrandoTrabalhadores || Relogio::now() >= prazo) {
+            break;
+        }
+        cvFila.wait_until(trava, prazo);
+    }
+
+    size_t quantidade = std::min(fila.size(), configuracao.tamanhoMaximoLote);
+    std::vector<Pendente> lote;
+    lote.reserve(quantidade);
+    for (size_t i = 0; i < quantidade; i++) {
+        lote.push_back(std::move(fila.front()));
+        fila.pop_front();
+    }
+    bool restante = !fila.empty();
+    trava.unlock();
+    if (restante) cvFila.notify_one();
+    return lote;
+}
+
+void ServicoCriptografia::cicloTrabalhador() {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::unordered_map<uint64_t, std::array<uint64_t, 16>> subchavesDES;
+
+    while (true) {
+        std::vector<Pendente> lote = coletarLote();
+        if (lote.empty()) return;
+
+        // Subchaves DES valem para o lote inteiro: requisições com a mesma chave
+        // compartilham um único escalonamento
+        subchavesDES.clear();
+        std::vector<Concluida> respostas;
+        respostas.reserve(lote.size());
+        for (const Pendente& pendente : lote) {
+            Concluida concluida{pendente.conexao, {}};
+            Protocolo::serializarResposta(processar(pendente.requisicao, subchavesDES, gen), concluida.quadro);
+            respostas.push_back(std::move(concluida));
+        }
+
+        {
+            std::lock_guard<std::mutex> trava(mutexConcluidas);
+            for (Concluida& concluida : respostas) {
+                concluidas.push_back(std::move(concluida));
+            }
+        }
+        totalRequisicoes += lote.size();
+        totalLotes++;
+        sinalizar(fdDespertar);
+    }
+}
+
+Protocolo::Resposta ServicoCriptografia::processar(const Protocolo::Requisicao& requisicao,
+                                                   std::unordered_map<uint64_t, std::array<uint64_t, 16>>& subchavesDES,
+                                                   std::mt19937& gen) const {
+    using Protocolo::Algoritmo;
+    using Protocolo::Operacao;
+
+    Protocolo::Resposta resposta;
+    resposta.id = requisicao.id;
+    const std::string& dados = requisicao.dados;
+    bool criptografar = requisicao.operacao == Operacao::Criptografar;
+    // RSA e GM expandem cada byte em 4 e 32 bytes: recusa o que não caberia num quadro de resposta
+    auto respostaCabe = [](size_t bytes) { return bytes <= Protocolo::TAMANHO_MAXIMO_QUADRO - 5; };
+
+    if (requisicao.operacao != Operacao::Criptografar && requisicao.operacao != Operacao::Descriptografar) {
+        resposta.status = Protocolo::Status::Erro;
+        return resposta;
+    }
+
+    switch (requisicao.algoritmo) {
+        case Algoritmo::DES: {
+            if (dados.size() < sizeof(uint64_t)) break;
+            uint64_t chave = Protocolo::lerChaveDES(dados);
+            auto it = subchavesDES.find(chave);
+            if (it == subchavesDES.end()) {
+                it = subchavesDES.emplace(chave, DES::gerarSubchavesDES(chave)).first;
+            }
+            if (criptografar) {
+                resposta.dados = Protocolo::blocosParaBytes(DES::criptografarDES(dados.substr(sizeof(uint64_t)), it->second));
+            } else {
+                std::string_view blocos = std::string_view(dados).substr(sizeof(uint64_t));
+                if (blocos.size() % sizeof(uint64_t) != 0) break;
+                resposta.dados = DES::descriptografarDES(Protocolo::bytesParaBlocos(blocos), it->second);
+            }
+            return resposta;
+        }
+        case Algoritmo::RSA:
+            if (criptografar) {
+                if (!respostaCabe(dados.size() * sizeof(int32_t))) break;
+                resposta.dados = Protocolo::inteirosParaBytes(RSA::criptografarRSA(dados, chavePublicaRSA));
+            } else {
+                if (dados.size() % sizeof(int32_t) != 0) break;
+                resposta.dados = RSA::decriptografarRSA(Protocolo::bytesParaInteiros(dados), chavePrivadaRSA);
+            }
+            return resposta;
+        case Algoritmo::GM:
+            if (criptografar) {
+                if (!respostaCabe(dados.size() * 8 * sizeof(int32_t))) break;
+                resposta.dados = Protocolo::inteirosParaBytes(GM::criptografarGM(dados, chavePublicaGM, gen));
+            } else {
+                if (dados.size() % sizeof(int32_t) != 0) break;
+                resposta.dados = GM::descriptografarGM(Protocolo::bytesParaInteiros(dados), chavePrivadaGM);
+            }
+            return resposta;
+    }
+
+    resposta.status = Protocolo::Status::Erro;
+    resposta.dados.clear();
+    return resposta;
+}
+}